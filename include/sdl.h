@@ -3,5 +3,8 @@
 
 SDL_Texture* loadTexture(const char* path, SDL_Renderer* renderer);
 SDL_Texture* renderText(const char* message, const char* fontFile, SDL_Color color, int fontSize, SDL_Renderer* renderer);
+void destroyTexture(SDL_Texture* texture);
+Mix_Chunk* loadSound(const char* path);
+void freeSound(Mix_Chunk* chunk);
 
 #endif
\ No newline at end of file
@@ -42,10 +42,13 @@ typedef struct {
     Enemy* enemies;
     Turret* turrets;
     Level* level;
+    SDL_Texture* staticLayer; //background + turrets, render target
+    bool staticLayerDirty;
 } GAME_STATE;
 
 void move(Enemy* enemy, Level* level, GAME_STATE* game,Mix_Chunk* enemySound);
 void upgradeTurret(Turret* turret,GAME_STATE* game, SDL_Renderer* renderer, Mix_Chunk* uiAudio[4]);
+void renderStaticLayer(GAME_STATE* game, SDL_Renderer* renderer);
 bool positionOnTurret(int mouseX, int mouseY, Turret* turret);
 Enemy* createEnemies(int wave, SDL_Texture* enemyTexture);
 void turretShoot(Turret* turret, Enemy* enemies, int enemyCount, GAME_STATE* game);
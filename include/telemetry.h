@@ -0,0 +1,22 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#define TELEMETRY_MAX_TICKS 512 //tick samples kept per second, more than enough at ~60-125fps
+#define TELEMETRY_QUEUE_SIZE 64 //records waiting for the writer thread, dropped when full
+
+//counters bumped from the game loop, only ever touched by the main thread
+//shots and drawCalls only ever get reported as deltas, unsigned so wrapping around on long soaks keeps those right
+typedef struct {
+    Uint32 shots;
+    Uint32 drawCalls;
+    int liveTextures; //loadTexture + renderText minus destroyTexture
+    int liveChunks; //loadSound minus freeSound
+} TelemetryCounters;
+
+extern TelemetryCounters telemetry;
+
+void telemetryStart(const char* target);
+void telemetryTick(int wave, int health, int currency, int liveEnemies, float tickMs);
+void telemetryStop();
+
+#endif
@@ -7,6 +7,7 @@
 #include <time.h>
 #include "sdl.h"
 #include "system.h"
+#include "telemetry.h"
 
 const int WINDOW_WIDTH = 1472;
 const int WINDOW_HEIGHT = 768;
@@ -32,7 +33,7 @@ int main() {
         printf("TTF_Init: %s\n", TTF_GetError());
         return 1;
     }
-    window = SDL_CreateWindow("RTD: A Tower Defense!", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_SHOWN);
+    window = SDL_CreateWindow("RTD: A Tower Defense!", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
     if (!window) {
         printf("Window Creation Error: %s\n", SDL_GetError());
         SDL_Quit();
@@ -45,6 +46,8 @@ int main() {
         SDL_Quit();
         return 1;
     }
+    //everything is drawn at 1472x768 and scaled (letterboxed) to whatever size the window is
+    SDL_RenderSetLogicalSize(renderer, WINDOW_WIDTH, WINDOW_HEIGHT);
     if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
         printf("SDL_image Initialization Error: %s\n", IMG_GetError());
         SDL_DestroyRenderer(renderer);
@@ -61,7 +64,7 @@ int main() {
     }
     if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
         printf("SDL_mixer Initialization Error: %s\n", Mix_GetError());
-        SDL_DestroyTexture(enemyTexture);
+        destroyTexture(enemyTexture);
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
         IMG_Quit();
@@ -72,7 +75,7 @@ int main() {
     if (!backgroundMusic) {
         printf("Loading background music failed! SDL_mixer Error: %s\n", Mix_GetError());
         Mix_CloseAudio();
-        SDL_DestroyTexture(enemyTexture);
+        destroyTexture(enemyTexture);
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
         IMG_Quit();
@@ -86,8 +89,20 @@ int main() {
         SDL_Quit();
         return 1;
     }
+    //background + turrets cached in one texture, redrawn only when a turret gets upgraded
+    game->staticLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (!game->staticLayer) {
+        printf("Static layer Creation Error: %s\n", SDL_GetError());
+        destroyTexture(enemyTexture);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+    //only the big background layer gets smoothed when scaled, sprites keep their nearest filtering
+    SDL_SetTextureScaleMode(game->staticLayer, SDL_ScaleModeLinear);
     Mix_PlayMusic(backgroundMusic, -1);
-    enemySound =  Mix_LoadWAV("assets/sfx/enemy.wav");
+    enemySound =  loadSound("assets/sfx/enemy.wav");
     
     Position nodes[] = {{0, 64*9}, {64*3, 64*9}, {64*3, 64*3}, {64*6, 64*3},{64*6,64*7},{64*19,64*7},{64*19,64*4},{64*16,64*4},{64*16,64*9},{64*13,64*12}};
     game->level = initLevel(0, 10, 7, nodes, backgroundTexture);
@@ -103,10 +118,12 @@ int main() {
     game->turrets[6] = (Turret){{32*1, 32*23}, 0, 24, 4, 200, 280, 400, loadTexture("assets/sprites/sniperTurretBox.png",renderer),NULL};
 
     //UI SFX
-    uiAudio[0] = Mix_LoadWAV("assets/sfx/yes.wav");
-    uiAudio[1] = Mix_LoadWAV("assets/sfx/no.wav");
-    uiAudio[2] = Mix_LoadWAV("assets/sfx/win.wav");
-    uiAudio[3] = Mix_LoadWAV("assets/sfx/loose.wav");
+    uiAudio[0] = loadSound("assets/sfx/yes.wav");
+    uiAudio[1] = loadSound("assets/sfx/no.wav");
+    uiAudio[2] = loadSound("assets/sfx/win.wav");
+    uiAudio[3] = loadSound("assets/sfx/loose.wav");
+    //TELEMETRY, off unless RTD_TELEMETRY points at a file or unix: socket
+    telemetryStart(getenv("RTD_TELEMETRY"));
     //GAME LOOP
     bool quit = false;
     bool gameover = false;
@@ -114,9 +131,13 @@ int main() {
     SDL_Event e;
     while (!quit) {
         //SDL_Log("Game loop");
+        Uint64 tickStart = SDL_GetPerformanceCounter();
+        int liveEnemies = 0;
         while (SDL_PollEvent(&e) != 0) {
             if (e.type == SDL_QUIT) {
                 quit = true;
+            } else if (e.type == SDL_RENDER_TARGETS_RESET) {
+                game->staticLayerDirty = true;
             } else if (e.type == SDL_MOUSEBUTTONDOWN) {
                 int mouseX = e.button.x;
                 int mouseY = e.button.y;
@@ -160,34 +181,39 @@ int main() {
                 turretShoot(&game->turrets[i], game->enemies, enemyCount, game);
             }
             
+            if (game->staticLayerDirty) {
+                renderStaticLayer(game, renderer);
+            }
             SDL_SetRenderDrawColor(renderer, 172, 79, 198, 255);
             SDL_RenderClear(renderer);
 
             SDL_Rect backgroundRect = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-            SDL_RenderCopy(renderer, game->level->texture, NULL, &backgroundRect);
+            SDL_RenderCopy(renderer, game->staticLayer, NULL, &backgroundRect);
+            telemetry.drawCalls++;
             
             for (int i = 0; i < enemyCount; i++) {
                 if (game->enemies[i].alive) {
                     SDL_Rect enemyRect = {game->enemies[i].position.x-20, game->enemies[i].position.y-20, 40, 40};
                     SDL_RenderCopy(renderer, game->enemies[i].texture, NULL, &enemyRect);
+                    telemetry.drawCalls++;
                     SDL_Rect healthBarRect = {game->enemies[i].position.x - 20, game->enemies[i].position.y - 30, (int)(40 * ((float)game->enemies[i].health / ((140*pow(1.2,game->wave-1))/(pow(1.12,game->wave))))), 5};
                     SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
                     SDL_RenderFillRect(renderer, &healthBarRect);
+                    telemetry.drawCalls++;
                 }
             }
-            
-            for (int i = 0; i < game->level->maxTurrets; i++) {
-                if (game->turrets[i].texture != NULL) {
-                    SDL_Rect turretRect = {game->turrets[i].position.x - 20, game->turrets[i].position.y - 20, 40, 40};
-                    SDL_RenderCopy(renderer, game->turrets[i].texture, NULL, &turretRect);
-                }
-            }
+
 
             //ON SCREEN TEXT
             char buffer[50];
             SDL_Texture* gui[4];
             int mouseX, mouseY;
+            float logicalX, logicalY;
             SDL_GetMouseState(&mouseX, &mouseY);
+            //mouse state is in window pixels, turrets and hud are in logical ones
+            SDL_RenderWindowToLogical(renderer, mouseX, mouseY, &logicalX, &logicalY);
+            mouseX = (int)logicalX;
+            mouseY = (int)logicalY;
             sprintf(buffer, "Wave: %d", game->wave);
             gui[0] = renderText(buffer, "assets/fonts/Arial.ttf", darkColor, 40, renderer);
             sprintf(buffer, "HP: %d", game->health);
@@ -203,7 +229,8 @@ int main() {
                 SDL_QueryTexture(gui[0], NULL, NULL, &texW, &texH);
                 SDL_Rect dstRect = {WINDOW_WIDTH/2-texW/2, 10, texW, texH};
                 SDL_RenderCopy(renderer, gui[0], NULL, &dstRect);
-                SDL_DestroyTexture(gui[0]);
+                telemetry.drawCalls++;
+                destroyTexture(gui[0]);
             }
             for (int i = 0; i < 3; i++) {
                 if (gui[i+1]) {
@@ -211,7 +238,8 @@ int main() {
                 SDL_QueryTexture(gui[i+1], NULL, NULL, &texW, &texH);
                 SDL_Rect dstRect = {10, 10 + i * 35, texW, texH};
                 SDL_RenderCopy(renderer, gui[i+1], NULL, &dstRect);
-                SDL_DestroyTexture(gui[i+1]);
+                telemetry.drawCalls++;
+                destroyTexture(gui[i+1]);
                 }
             }
             //moouse position
@@ -222,7 +250,8 @@ int main() {
                 SDL_QueryTexture(mouseText, NULL, NULL, &texW, &texH);
                 SDL_Rect dstRect = {WINDOW_WIDTH - texW - 10, 10, texW, texH};
                 SDL_RenderCopy(renderer, mouseText, NULL, &dstRect);
-                SDL_DestroyTexture(mouseText);
+                telemetry.drawCalls++;
+                destroyTexture(mouseText);
             }
             for (int i = 0; i < game->level->maxTurrets; i++) {
                 if (positionOnTurret(mouseX, mouseY, &game->turrets[i])) {
@@ -242,7 +271,8 @@ int main() {
                             SDL_QueryTexture(turretInfo[i], NULL, NULL, &texW, &texH);
                             SDL_Rect dstRect = {WINDOW_WIDTH-texW-10, 40 + i * 30, texW, texH};
                             SDL_RenderCopy(renderer, turretInfo[i], NULL, &dstRect);
-                            SDL_DestroyTexture(turretInfo[i]);
+                            telemetry.drawCalls++;
+                            destroyTexture(turretInfo[i]);
                         }
                     }
                 }
@@ -250,6 +280,7 @@ int main() {
             if (game->health <= 0) {
                 gameover = true;
             }
+            liveEnemies = enemiesLeft;
         }
         else{
             Mix_HaltMusic();
@@ -276,7 +307,8 @@ int main() {
                 SDL_QueryTexture(gameOverTexture, NULL, NULL, &texW, &texH);
                 SDL_Rect dstRect = {WINDOW_WIDTH / 2 - texW / 2, WINDOW_HEIGHT / 2 - texH / 2 - 50, texW, texH};
                 SDL_RenderCopy(renderer, gameOverTexture, NULL, &dstRect);
-                SDL_DestroyTexture(gameOverTexture);
+                telemetry.drawCalls++;
+                destroyTexture(gameOverTexture);
             }
             if (game->wave < 30){
                 sprintf(buffer, "Loosing wave: %d", game->wave);
@@ -290,11 +322,13 @@ int main() {
                 SDL_QueryTexture(lastWaveTexture, NULL, NULL, &texW, &texH);
                 SDL_Rect dstRect = {WINDOW_WIDTH / 2 - texW / 2, WINDOW_HEIGHT / 2 - texH / 2 + 50, texW, texH};
                 SDL_RenderCopy(renderer, lastWaveTexture, NULL, &dstRect);
-                SDL_DestroyTexture(lastWaveTexture);
+                telemetry.drawCalls++;
+                destroyTexture(lastWaveTexture);
             }
         }
 
         SDL_RenderPresent(renderer);
+        telemetryTick(game->wave, game->health, game->currency, liveEnemies, (SDL_GetPerformanceCounter() - tickStart) * 1000.0f / SDL_GetPerformanceFrequency());
         //Funny buisness
         if (game->wave <= 10){
              SDL_Delay(16); //+-60fps
@@ -316,23 +350,25 @@ int main() {
         }
     }
     // FREEING MEMORY
+    telemetryStop();
     for (int i = 0; i < game->level->maxTurrets; i++)
     {
-        SDL_DestroyTexture(game->turrets[i].texture);
-        Mix_FreeChunk(game->turrets[i].turretShootSound);
+        destroyTexture(game->turrets[i].texture);
+        freeSound(game->turrets[i].turretShootSound);
     }
+    SDL_DestroyTexture(game->staticLayer);
     free(game->enemies);
     free(game->turrets);
     free(game->level);
     free(game);
-    SDL_DestroyTexture(backgroundTexture);
-    SDL_DestroyTexture(enemyTexture);
+    destroyTexture(backgroundTexture);
+    destroyTexture(enemyTexture);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     Mix_FreeMusic(backgroundMusic);
-    Mix_FreeChunk(enemySound);
+    freeSound(enemySound);
     for (int i = 0; i < 4; i++) {
-        Mix_FreeChunk(uiAudio[i]);
+        freeSound(uiAudio[i]);
     }
     Mix_CloseAudio();
     IMG_Quit();
@@ -2,6 +2,8 @@
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
+#include <stdio.h>
+#include "telemetry.h"
 
 SDL_Texture* loadTexture(const char* path, SDL_Renderer* renderer) {
     SDL_Texture* newTexture = NULL;
@@ -12,6 +14,8 @@ SDL_Texture* loadTexture(const char* path, SDL_Renderer* renderer) {
         newTexture = SDL_CreateTextureFromSurface(renderer, loadedSurface);
         if (newTexture == NULL) {
             printf("Creating a texture from %s failed! SDL Error: %s\n", path, SDL_GetError());
+        } else {
+            telemetry.liveTextures++;
         }
         SDL_FreeSurface(loadedSurface);
     }
@@ -32,5 +36,28 @@ SDL_Texture* renderText(const char* message, const char* fontFile, SDL_Color col
     SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
     SDL_FreeSurface(surface);
     TTF_CloseFont(font);
+    if (texture) {
+        telemetry.liveTextures++;
+    }
     return texture;
+}
+//counterparts of the loaders above, keep telemetry's live counts in sync
+void destroyTexture(SDL_Texture* texture) {
+    if (texture) {
+        telemetry.liveTextures--;
+        SDL_DestroyTexture(texture);
+    }
+}
+Mix_Chunk* loadSound(const char* path) {
+    Mix_Chunk* chunk = Mix_LoadWAV(path);
+    if (chunk) {
+        telemetry.liveChunks++;
+    }
+    return chunk;
+}
+void freeSound(Mix_Chunk* chunk) {
+    if (chunk) {
+        telemetry.liveChunks--;
+        Mix_FreeChunk(chunk);
+    }
 }
\ No newline at end of file
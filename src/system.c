@@ -7,6 +7,7 @@
 #include <time.h>
 #include "sdl.h"
 #include "system.h"
+#include "telemetry.h"
 
 Level* initLevel(int startCurrency, int nodeCount, int maxTurrets, Position* nodes, SDL_Texture* texture) {
     Level* level = malloc(sizeof(Level));
@@ -27,6 +28,8 @@ GAME_STATE* initGame() {
     game->enemies = NULL;
     game->turrets = NULL;
     game->level = NULL;
+    game->staticLayer = NULL;
+    game->staticLayerDirty = true;
     return game;
 }
 int calculateEnemiesToSpawn(int wave) {
@@ -49,6 +52,7 @@ void turretShoot(Turret* turret, Enemy* enemies, int enemyCount, GAME_STATE* gam
                     }
                     turret->cooldown = turret->speed;
                     Mix_PlayChannel(-1, turret->turretShootSound, 0);
+                    telemetry.shots++;
                 }
                 else if (turret->type == 2) {
                     enemies[i].health -= turret->damage*1.5;
@@ -58,6 +62,7 @@ void turretShoot(Turret* turret, Enemy* enemies, int enemyCount, GAME_STATE* gam
                     }
                     turret->cooldown = turret->speed;
                     Mix_PlayChannel(-1, turret->turretShootSound, 0);
+                    telemetry.shots++;
                 } 
                 else if (turret->type == 3) {
                     enemies[i].health -= turret->damage*2;
@@ -67,6 +72,7 @@ void turretShoot(Turret* turret, Enemy* enemies, int enemyCount, GAME_STATE* gam
                     }
                     turret->cooldown = turret->speed;
                     Mix_PlayChannel(-1, turret->turretShootSound, 0);
+                    telemetry.shots++;
                 } 
                 //SNIPER TURRET
                 else if (turret->type == 5) {
@@ -77,6 +83,7 @@ void turretShoot(Turret* turret, Enemy* enemies, int enemyCount, GAME_STATE* gam
                     }
                     turret->cooldown = turret->speed;
                     Mix_PlayChannel(-1, turret->turretShootSound, 0);
+                    telemetry.shots++;
                 } 
                 else if (turret->type == 6) {
                     enemies[i].health -= turret->damage*2; 
@@ -86,6 +93,7 @@ void turretShoot(Turret* turret, Enemy* enemies, int enemyCount, GAME_STATE* gam
                     }
                     turret->cooldown = turret->speed;
                     Mix_PlayChannel(-1, turret->turretShootSound, 0);
+                    telemetry.shots++;
                 } 
                 else if (turret->type == 7) {
                     enemies[i].health -= turret->damage*4; 
@@ -95,6 +103,7 @@ void turretShoot(Turret* turret, Enemy* enemies, int enemyCount, GAME_STATE* gam
                     }
                     turret->cooldown = turret->speed;
                     Mix_PlayChannel(-1, turret->turretShootSound, 0);
+                    telemetry.shots++;
                 }
             }
         }
@@ -125,6 +134,29 @@ bool positionOnTurret(int mouseX, int mouseY, Turret* turret) {
            mouseY >= turret->position.y - 20 && mouseY <= turret->position.y + 20;
 }
 //SDL
+//REDRAWS THE CACHED BACKGROUND + TURRETS, CALLED ONLY WHEN SOMETHING ON IT CHANGED
+void renderStaticLayer(GAME_STATE* game, SDL_Renderer* renderer) {
+    if (SDL_SetRenderTarget(renderer, game->staticLayer) < 0) {
+        printf("Static layer render target Error: %s\n", SDL_GetError());
+        return; //stays dirty, tried again next frame
+    }
+    SDL_SetRenderDrawColor(renderer, 172, 79, 198, 255);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, game->level->texture, NULL, NULL);
+    telemetry.drawCalls++;
+    for (int i = 0; i < game->level->maxTurrets; i++) {
+        if (game->turrets[i].texture != NULL) {
+            SDL_Rect turretRect = {game->turrets[i].position.x - 20, game->turrets[i].position.y - 20, 40, 40};
+            SDL_RenderCopy(renderer, game->turrets[i].texture, NULL, &turretRect);
+            telemetry.drawCalls++;
+        }
+    }
+    if (SDL_SetRenderTarget(renderer, NULL) < 0) {
+        printf("Static layer render target Error: %s\n", SDL_GetError());
+        return;
+    }
+    game->staticLayerDirty = false;
+}
 
 //LOGIC FOR UPGRADING TURRETS AND THEIR TYPES --- ALSO HANDLES CURRENCEY DEDUCTION && TEXTURE CHANGES && STATS CHANGES
 void upgradeTurret(Turret* turret,GAME_STATE* game, SDL_Renderer* renderer, Mix_Chunk* uiAudio[4]) {
@@ -133,10 +165,11 @@ void upgradeTurret(Turret* turret,GAME_STATE* game, SDL_Renderer* renderer, Mix_
         turret->type = 1;
         game->currency -= turret->price;
         turret->price = turret->price*1.5;
-        SDL_DestroyTexture(turret->texture);
-        Mix_FreeChunk(turret->turretShootSound);
+        destroyTexture(turret->texture);
+        freeSound(turret->turretShootSound);
         turret->texture = loadTexture("assets/sprites/electricTurretT1.png", renderer);
-        turret->turretShootSound = Mix_LoadWAV("assets/sfx/zapTowerA.wav");
+        game->staticLayerDirty = true;
+        turret->turretShootSound = loadSound("assets/sfx/zapTowerA.wav");
         Mix_PlayChannel(-1, uiAudio[0], 0);
     }
     else if (turret->type == 1 && game->currency >= turret->price) {
@@ -144,10 +177,11 @@ void upgradeTurret(Turret* turret,GAME_STATE* game, SDL_Renderer* renderer, Mix_
         game->currency -= turret->price;
         turret->price = turret->price*1.5;
         turret->speed = turret->speed/2;
-        SDL_DestroyTexture(turret->texture);
-        Mix_FreeChunk(turret->turretShootSound);
+        destroyTexture(turret->texture);
+        freeSound(turret->turretShootSound);
         turret->texture = loadTexture("assets/sprites/electricTurretT2.png", renderer);
-        turret->turretShootSound = Mix_LoadWAV("assets/sfx/zapTowerA.wav");
+        game->staticLayerDirty = true;
+        turret->turretShootSound = loadSound("assets/sfx/zapTowerA.wav");
         Mix_PlayChannel(-1, uiAudio[0], 0);
     }
     else if (turret->type == 2 && game->currency >= turret->price) {
@@ -157,10 +191,11 @@ void upgradeTurret(Turret* turret,GAME_STATE* game, SDL_Renderer* renderer, Mix_
         turret->speed = turret->speed + 2;
         turret->range = turret->range + 20;
         turret->damage = turret->damage + 10;
-        SDL_DestroyTexture(turret->texture);
-        Mix_FreeChunk(turret->turretShootSound);
+        destroyTexture(turret->texture);
+        freeSound(turret->turretShootSound);
         turret->texture = loadTexture("assets/sprites/electricTurretT3.png", renderer);
-        turret->turretShootSound = Mix_LoadWAV("assets/sfx/zapTowerA.wav");
+        game->staticLayerDirty = true;
+        turret->turretShootSound = loadSound("assets/sfx/zapTowerA.wav");
         Mix_PlayChannel(-1, uiAudio[0], 0);
     }
     //"SNIPER TURRET"
@@ -168,10 +203,11 @@ void upgradeTurret(Turret* turret,GAME_STATE* game, SDL_Renderer* renderer, Mix_
         turret->type = 5;
         game->currency -= turret->price;
         turret->price = turret->price*2;
-        SDL_DestroyTexture(turret->texture);
-        Mix_FreeChunk(turret->turretShootSound);
+        destroyTexture(turret->texture);
+        freeSound(turret->turretShootSound);
         turret->texture = loadTexture("assets/sprites/sniperTurretT1.png", renderer);
-        turret->turretShootSound = Mix_LoadWAV("assets/sfx/sniperTowerB.wav");
+        game->staticLayerDirty = true;
+        turret->turretShootSound = loadSound("assets/sfx/sniperTowerB.wav");
         Mix_PlayChannel(-1, uiAudio[0], 0);
     }
     else if (turret->type == 5 && game->currency >= turret->price) {
@@ -179,10 +215,11 @@ void upgradeTurret(Turret* turret,GAME_STATE* game, SDL_Renderer* renderer, Mix_
         game->currency -= turret->price;
         turret->price = turret->price*1.5;
         turret->damage = turret->damage*2;
-        SDL_DestroyTexture(turret->texture);
-        Mix_FreeChunk(turret->turretShootSound);
+        destroyTexture(turret->texture);
+        freeSound(turret->turretShootSound);
         turret->texture = loadTexture("assets/sprites/sniperTurretT2.png", renderer);
-        turret->turretShootSound = Mix_LoadWAV("assets/sfx/sniperTowerB.wav");
+        game->staticLayerDirty = true;
+        turret->turretShootSound = loadSound("assets/sfx/sniperTowerB.wav");
         Mix_PlayChannel(-1, uiAudio[0], 0);
     }
     else if (turret->type == 6 && game->currency >= turret->price) {
@@ -192,10 +229,11 @@ void upgradeTurret(Turret* turret,GAME_STATE* game, SDL_Renderer* renderer, Mix_
         turret->damage = turret->damage*1.5;
         turret->range = turret->range + 100;
         turret->speed = turret->speed - 2;
-        SDL_DestroyTexture(turret->texture);
-        Mix_FreeChunk(turret->turretShootSound);
+        destroyTexture(turret->texture);
+        freeSound(turret->turretShootSound);
         turret->texture = loadTexture("assets/sprites/sniperTurretT3.png", renderer);
-        turret->turretShootSound = Mix_LoadWAV("assets/sfx/sniperTowerB.wav");
+        game->staticLayerDirty = true;
+        turret->turretShootSound = loadSound("assets/sfx/sniperTowerB.wav");
         Mix_PlayChannel(-1, uiAudio[0], 0);
     }
     //UPGRADING FINAL TIERS
@@ -0,0 +1,300 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef __unix__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include "telemetry.h"
+
+typedef struct {
+    bool wave; //false = per second record
+    Uint64 time;
+    float seconds;
+    int waveNumber;
+    int health;
+    int currency;
+    int liveEnemies;
+    int frames;
+    int dropped;
+    TelemetryCounters counters; //shots and draw calls are per record, live counts are current values
+    float tickSum;
+    float tickMax;
+    int tickCount;
+    float ticks[TELEMETRY_MAX_TICKS];
+} TelemetryRecord;
+
+TelemetryCounters telemetry = {0, 0, 0, 0};
+
+//set up before the writer starts, the queue itself is guarded by lock
+static FILE* output = NULL;
+static int socketFd = -1;
+static bool json = false;
+static SDL_Thread* writer = NULL;
+static SDL_mutex* lock = NULL;
+static SDL_cond* wake = NULL;
+static bool running = false;
+static TelemetryRecord queue[TELEMETRY_QUEUE_SIZE];
+static int queueHead = 0;
+static int queueCount = 0;
+
+//only used by the game loop
+static TelemetryRecord secondRecord;
+static TelemetryRecord waveRecord;
+static TelemetryCounters secondStart;
+static TelemetryCounters waveStart;
+static int dropped = 0;
+static int lastHealth = 0; //game state from the latest tick, so telemetryStop can finish the open records
+static int lastCurrency = 0;
+static int lastLiveEnemies = 0;
+
+static long readRssKb() {
+#ifdef __linux__
+    long pages = 0, resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return 0;
+    }
+    if (fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(statm);
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return 0;
+#endif
+}
+static int compareTicks(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+//nearest rank, ticks must be sorted
+static float percentile(float* ticks, int count, int p) {
+    int rank = (p * count + 99) / 100;
+    return ticks[rank > 0 ? rank - 1 : 0];
+}
+static void emit(const char* line) {
+#ifdef __unix__
+    if (socketFd >= 0) {
+        //MSG_NOSIGNAL so a closed reader doesn't kill the game with SIGPIPE
+        send(socketFd, line, strlen(line), MSG_NOSIGNAL);
+        return;
+    }
+#endif
+    fputs(line, output);
+    fflush(output);
+}
+//WRITER THREAD SIDE --- FORMATS AND WRITES RECORDS, ALL THE I/O HAPPENS HERE
+static void writeRecord(TelemetryRecord* record) {
+    char line[1024];
+    char percentiles[96] = "";
+    long rss = readRssKb();
+    Uint64 rssTime = SDL_GetTicks64(); //rss is read here, not when the record closed, so it can lag time_ms if the queue backs up
+    float mean = record->frames > 0 ? record->tickSum / record->frames : 0;
+    float shotsPerSecond = record->seconds > 0 ? record->counters.shots / record->seconds : 0;
+
+    if (record->tickCount > 0) {
+        qsort(record->ticks, record->tickCount, sizeof(float), compareTicks);
+        float p50 = percentile(record->ticks, record->tickCount, 50);
+        float p95 = percentile(record->ticks, record->tickCount, 95);
+        float p99 = percentile(record->ticks, record->tickCount, 99);
+        if (json) {
+            snprintf(percentiles, sizeof(percentiles), "\"tick_p50_ms\":%.3f,\"tick_p95_ms\":%.3f,\"tick_p99_ms\":%.3f,", p50, p95, p99);
+        } else {
+            snprintf(percentiles, sizeof(percentiles), "%.3f,%.3f,%.3f,", p50, p95, p99);
+        }
+    } else if (!json) {
+        strcpy(percentiles, ",,,");
+    }
+    if (json) {
+        snprintf(line, sizeof(line),
+            "{\"kind\":\"%s\",\"time_ms\":%llu,\"wave\":%d,\"seconds\":%.3f,\"health\":%d,\"currency\":%d,\"live_enemies\":%d,"
+            "\"frames\":%d,\"shots\":%u,\"shots_per_sec\":%.2f,\"draw_calls\":%u,\"tick_mean_ms\":%.3f,%s\"tick_max_ms\":%.3f,"
+            "\"rss_kb\":%ld,\"rss_sampled_ms\":%llu,\"live_textures\":%d,\"live_chunks\":%d,\"dropped\":%d}\n",
+            record->wave ? "wave" : "second", (unsigned long long)record->time, record->waveNumber, record->seconds,
+            record->health, record->currency, record->liveEnemies, record->frames, (unsigned)record->counters.shots, shotsPerSecond,
+            (unsigned)record->counters.drawCalls, mean, percentiles, record->tickMax, rss, (unsigned long long)rssTime, record->counters.liveTextures,
+            record->counters.liveChunks, record->dropped);
+    } else {
+        snprintf(line, sizeof(line), "%s,%llu,%d,%.3f,%d,%d,%d,%d,%u,%.2f,%u,%.3f,%s%.3f,%ld,%llu,%d,%d,%d\n",
+            record->wave ? "wave" : "second", (unsigned long long)record->time, record->waveNumber, record->seconds,
+            record->health, record->currency, record->liveEnemies, record->frames, (unsigned)record->counters.shots, shotsPerSecond,
+            (unsigned)record->counters.drawCalls, mean, percentiles, record->tickMax, rss, (unsigned long long)rssTime, record->counters.liveTextures,
+            record->counters.liveChunks, record->dropped);
+    }
+    emit(line);
+}
+static int writerThread(void* data) {
+    (void)data;
+    static TelemetryRecord record;
+    SDL_LockMutex(lock);
+    while (running || queueCount > 0) {
+        if (queueCount == 0) {
+            SDL_CondWait(wake, lock);
+            continue;
+        }
+        record = queue[queueHead];
+        queueHead = (queueHead + 1) % TELEMETRY_QUEUE_SIZE;
+        queueCount--;
+        SDL_UnlockMutex(lock);
+        writeRecord(&record);
+        SDL_LockMutex(lock);
+    }
+    SDL_UnlockMutex(lock);
+    return 0;
+}
+//GAME LOOP SIDE --- ONLY COPIES RECORDS INTO THE QUEUE, NEVER WAITS ON THE WRITER
+static void push(TelemetryRecord* record) {
+    SDL_LockMutex(lock);
+    if (queueCount == TELEMETRY_QUEUE_SIZE) {
+        dropped++;
+    } else {
+        record->dropped = dropped;
+        queue[(queueHead + queueCount) % TELEMETRY_QUEUE_SIZE] = *record;
+        queueCount++;
+        SDL_CondSignal(wake);
+    }
+    SDL_UnlockMutex(lock);
+}
+static void resetRecord(TelemetryRecord* record, TelemetryCounters* start, bool isWave, int waveNumber) {
+    memset(record, 0, offsetof(TelemetryRecord, ticks));
+    record->wave = isWave;
+    record->waveNumber = waveNumber;
+    record->time = SDL_GetTicks64();
+    *start = telemetry;
+}
+static void finishRecord(TelemetryRecord* record, TelemetryCounters* start) {
+    Uint64 now = SDL_GetTicks64();
+    record->seconds = (now - record->time) / 1000.0f;
+    record->time = now;
+    record->health = lastHealth;
+    record->currency = lastCurrency;
+    record->liveEnemies = lastLiveEnemies;
+    record->counters.shots = telemetry.shots - start->shots;
+    record->counters.drawCalls = telemetry.drawCalls - start->drawCalls;
+    record->counters.liveTextures = telemetry.liveTextures;
+    record->counters.liveChunks = telemetry.liveChunks;
+    push(record);
+}
+
+//target is a file path (.csv, or .jsonl/.ndjson for newline json) or unix:/path/to/socket, NULL turns telemetry off
+void telemetryStart(const char* target) {
+    if (target == NULL || target[0] == '\0') {
+        return;
+    }
+    size_t length = strlen(target);
+    json = (length > 6 && strcmp(target + length - 6, ".jsonl") == 0) ||
+           (length > 7 && strcmp(target + length - 7, ".ndjson") == 0);
+    if (strncmp(target, "unix:", 5) == 0) {
+#ifdef __unix__
+        struct sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, target + 5, sizeof(address.sun_path) - 1);
+        socketFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socketFd < 0 || connect(socketFd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+            printf("Telemetry socket %s could not be opened, telemetry is off\n", target + 5);
+            if (socketFd >= 0) {
+                close(socketFd);
+            }
+            socketFd = -1;
+            return;
+        }
+        json = true; //sockets always get newline json
+#else
+        printf("Telemetry sockets are not supported on this platform, telemetry is off\n");
+        return;
+#endif
+    } else {
+        output = fopen(target, "w");
+        if (!output) {
+            printf("Telemetry file %s could not be opened, telemetry is off\n", target);
+            return;
+        }
+        if (!json) {
+            fputs("kind,time_ms,wave,seconds,health,currency,live_enemies,frames,shots,shots_per_sec,draw_calls,"
+                  "tick_mean_ms,tick_p50_ms,tick_p95_ms,tick_p99_ms,tick_max_ms,rss_kb,rss_sampled_ms,live_textures,live_chunks,dropped\n", output);
+        }
+    }
+    lock = SDL_CreateMutex();
+    wake = SDL_CreateCond();
+    running = true;
+    writer = SDL_CreateThread(writerThread, "telemetry", NULL);
+    if (!writer) {
+        printf("Telemetry thread Creation Error: %s\n", SDL_GetError());
+        running = false;
+        telemetryStop();
+        return;
+    }
+    resetRecord(&secondRecord, &secondStart, false, 0);
+    resetRecord(&waveRecord, &waveStart, true, 1);
+}
+//called once per frame after presenting, tickMs is how long the frame took without the delay
+void telemetryTick(int wave, int health, int currency, int liveEnemies, float tickMs) {
+    if (!running) {
+        return;
+    }
+    lastHealth = health;
+    lastCurrency = currency;
+    lastLiveEnemies = liveEnemies;
+    if (secondRecord.tickCount < TELEMETRY_MAX_TICKS) {
+        secondRecord.ticks[secondRecord.tickCount++] = tickMs;
+    }
+    secondRecord.frames++;
+    secondRecord.tickSum += tickMs;
+    secondRecord.tickMax = tickMs > secondRecord.tickMax ? tickMs : secondRecord.tickMax;
+    waveRecord.frames++;
+    waveRecord.tickSum += tickMs;
+    waveRecord.tickMax = tickMs > waveRecord.tickMax ? tickMs : waveRecord.tickMax;
+
+    if (wave != waveRecord.waveNumber) {
+        finishRecord(&waveRecord, &waveStart);
+        resetRecord(&waveRecord, &waveStart, true, wave);
+    }
+    if (SDL_GetTicks64() - secondRecord.time >= 1000) {
+        secondRecord.waveNumber = wave;
+        finishRecord(&secondRecord, &secondStart);
+        resetRecord(&secondRecord, &secondStart, false, wave);
+    }
+}
+//flushes the unfinished second and wave, lets the writer drain the queue, then closes the output
+void telemetryStop() {
+    if (writer) {
+        if (secondRecord.frames > 0) {
+            finishRecord(&secondRecord, &secondStart);
+        }
+        if (waveRecord.frames > 0) {
+            finishRecord(&waveRecord, &waveStart);
+        }
+        SDL_LockMutex(lock);
+        running = false;
+        SDL_CondSignal(wake);
+        SDL_UnlockMutex(lock);
+        SDL_WaitThread(writer, NULL);
+        writer = NULL;
+    }
+    if (wake) {
+        SDL_DestroyCond(wake);
+        wake = NULL;
+    }
+    if (lock) {
+        SDL_DestroyMutex(lock);
+        lock = NULL;
+    }
+    if (output) {
+        fclose(output);
+        output = NULL;
+    }
+#ifdef __unix__
+    if (socketFd >= 0) {
+        close(socketFd);
+        socketFd = -1;
+    }
+#endif
+}